@@ -20,3 +20,5 @@ LFLAGS ?= -lm
 OBJ_DIR := obj
 BIN_DIR := bin
 OBJ_EXT ?= .o
+# Q_PRIORITY_LEVELS values swept by "make bench"
+BENCH_PRIORITY_LEVELS ?= 3 8 32
@@ -10,7 +10,9 @@
     #define QCONFIG_H
 
     /*==================================================  CONFIGURATION FLAGS  =======================================================*/
-    #define Q_PRIORITY_LEVELS           ( 3 )       /**< The number of priorities available to the application tasks*/
+    #ifndef Q_PRIORITY_LEVELS
+        #define Q_PRIORITY_LEVELS       ( 3 )       /**< The number of priorities available to the application tasks (can be overridden from the command line, see "make bench")*/
+    #endif
     #define Q_SETUP_TIME_CANONICAL      ( 0 )       /**< If enabled, kernel assumes the timing Base to 1mS(1KHz). All time specifications for tasks and STimers must be set in mS*/
     #define Q_SETUP_TICK_IN_HERTZ       ( 0 )       /**< If enabled, the timing base will be taken as frequency(Hz) instead of period(S)*/
     #define Q_PRIO_QUEUE_SIZE           ( 10 )      /**< The size of the priority queue (use a 0(zero) value to disable it)*/
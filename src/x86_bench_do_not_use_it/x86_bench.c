@@ -0,0 +1,431 @@
+/*
+===================================================================================
+
+WARNING:
+
+This its just a micro-benchmark for x86 hosts. Dont use this as reference example
+in your embedded application.
+Results are printed as JSON lines (one object per measurement) to stdout, so they
+can be collected and compared between releases. Build and run it with "make bench"
+
+===================================================================================
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "QuarkTS.h"
+
+#if ( Q_ALLOW_SCHEDULER_RELEASE != 1 )
+    #error "x86_bench needs Q_ALLOW_SCHEDULER_RELEASE to leave qOS_Run after each measurement"
+#endif
+
+#ifndef CLOCK_MONOTONIC_RAW
+    #define CLOCK_MONOTONIC_RAW     CLOCK_MONOTONIC
+#endif
+
+#define BENCH_MAX_TASKS             ( 256u )
+#define BENCH_DISPATCH_TARGET       ( 200000uL )
+#define BENCH_LATENCY_SAMPLES       ( 20000uL )
+#define BENCH_QUEUE_ITEMS           ( 64u )
+#define BENCH_QUEUE_ROUNDS          ( 20000uL )
+#define BENCH_MEM_POOL_SIZE         ( 8192u )
+#define BENCH_MEM_ROUNDS            ( 200000uL )
+#define BENCH_WALK_ROUNDS           ( 100uL )
+
+#ifndef BENCH_LARGE_SORT
+    #define BENCH_LARGE_SORT        ( 0 )   /*also sort 100k nodes (slow while qList_Sort is quadratic)*/
+#endif
+
+typedef struct{
+    qNode_MinimalFields;
+    int value;
+    size_t order; /*insertion order, used to check the sort stability*/
+}benchnode_t;
+
+typedef struct{
+    const benchnode_t *previous;
+    qBool_t sorted;
+    qBool_t stable;
+}benchsortcheck_t;
+
+typedef enum{
+    BENCH_BY_SIMPLE_NOTIFICATION = 0,
+    BENCH_BY_QUEUED_NOTIFICATION,
+    BENCH_BY_YIELD_TO_TASK
+}benchdelivery_t;
+
+static const size_t TaskCountSweep[] = { 1u, 10u, 100u, BENCH_MAX_TASKS };
+static const size_t ListSizeSweep[] = { 10u, 100u, 1000u };
+#if ( BENCH_LARGE_SORT == 1 )
+static const size_t SortSizeSweep[] = { 10u, 1000u, 100000u };
+#else
+static const size_t SortSizeSweep[] = { 10u, 1000u };
+#endif
+static const size_t MemSizeSweep[] = { 16u, 64u, 256u };
+
+static qTask_t BenchTasks[ BENCH_MAX_TASKS ];
+static qTask_t SenderTask, ReceiverTask;
+static qUINT8_t MemPoolArea[ BENCH_MEM_POOL_SIZE ];
+
+static unsigned long DispatchCount = 0uL;
+static long WalkSum = 0L;
+static unsigned long LatencySamples = 0uL;
+static qUINT64_t LatencyStamp = 0uLL;
+static qUINT64_t LatencyTotal = 0uLL;
+static qBool_t LatencyPending = qFalse;
+static benchdelivery_t LatencyMode = BENCH_BY_SIMPLE_NOTIFICATION;
+static const char * const LatencyNames[] = { "notification_simple", "notification_queued", "yield_to_task" };
+
+/*===========================Reference clock for the kernel===================*/
+qClock_t GetTickCountMs(void){ /*get system background timer (1mS tick)*/
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (qClock_t)(ts.tv_nsec / (qClock_t)1000000uL) + ((qClock_t)ts.tv_sec * (qClock_t)1000uL);
+}
+/*============================================================================*/
+static qUINT64_t bench_Now( void ){ /*nanosecond timestamp, not slewed by NTP*/
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC_RAW, &ts );
+    return ( (qUINT64_t)ts.tv_sec * 1000000000uLL ) + (qUINT64_t)ts.tv_nsec;
+}
+/*============================================================================*/
+static void bench_Report( const char *name, size_t n, unsigned long ops, qUINT64_t elapsed ){
+    double nsPerOp = ( ops > 0uL ) ? ( (double)elapsed / (double)ops ) : 0.0;
+
+    printf( "{\"bench\":\"%s\",\"priority_levels\":%d,\"n\":%lu,\"ops\":%lu,\"total_ns\":%llu,\"ns_per_op\":%.2f}\n",
+            name, Q_PRIORITY_LEVELS, (unsigned long)n, ops, (unsigned long long)elapsed, nsPerOp );
+}
+/*============================================================================*/
+static void bench_KernelSetup( void ){
+    /*every measurement starts from a clean scheme*/
+    #if  (Q_SETUP_TIME_CANONICAL != 1)
+        qOS_Setup( GetTickCountMs, 0.001f, NULL );
+    #else
+        qOS_Setup( GetTickCountMs, NULL );
+    #endif
+    (void)memset( BenchTasks, 0, sizeof(BenchTasks) );
+    (void)memset( &SenderTask, 0, sizeof(SenderTask) );
+    (void)memset( &ReceiverTask, 0, sizeof(ReceiverTask) );
+}
+/*============================================================================*/
+static qBool_t bench_AddBackgroundTasks( size_t n, qTaskFcn_t callback ){
+    qBool_t retValue = qTrue;
+    size_t i;
+
+    for( i = 0u ; ( i < n ) && ( qTrue == retValue ) ; ++i ){
+        retValue = qOS_Add_Task( &BenchTasks[ i ], callback, (qPriority_t)( i % (size_t)Q_PRIORITY_LEVELS ), qTimeImmediate, qPeriodic, qEnabled, NULL );
+    }
+    return retValue;
+}
+/*============================================================================*/
+static void bench_NullCallback( qEvent_t e ){
+    (void)e;
+}
+/*============================================================================*/
+static void bench_DispatchCallback( qEvent_t e ){
+    (void)e;
+    if( ++DispatchCount >= BENCH_DISPATCH_TARGET ){
+        qOS_Scheduler_Release();
+    }
+}
+/*============================================================================*/
+static void bench_Dispatch( size_t nTasks ){
+    qUINT64_t t0;
+
+    bench_KernelSetup();
+    DispatchCount = 0uL;
+    if( qFalse == bench_AddBackgroundTasks( nTasks, bench_DispatchCallback ) ){
+        fprintf( stderr, "dispatch: unable to add %lu tasks\n", (unsigned long)nTasks );
+        return;
+    }
+    t0 = bench_Now();
+    qOS_Run();
+    bench_Report( "dispatch", nTasks, DispatchCount, bench_Now() - t0 );
+}
+/*============================================================================*/
+static void bench_SenderCallback( qEvent_t e ){
+    qBool_t sent;
+    (void)e;
+
+    if( qFalse == LatencyPending ){ /*only one notification in flight*/
+        LatencyPending = qTrue;
+        LatencyStamp = bench_Now();
+        switch( LatencyMode ){
+            case BENCH_BY_QUEUED_NOTIFICATION:
+                sent = qTask_Notification_Queue( &ReceiverTask, NULL );
+                break;
+            #if ( Q_ALLOW_YIELD_TO_TASK == 1 )
+            case BENCH_BY_YIELD_TO_TASK: /*the receiver runs before this call returns*/
+                sent = qTrue;
+                (void)qOS_YieldToTask( &ReceiverTask );
+                break;
+            #endif
+            default:
+                sent = qTask_Notification_Send( &ReceiverTask, NULL );
+                break;
+        }
+        if( qFalse == sent ){
+            LatencyPending = qFalse;
+        }
+    }
+}
+/*============================================================================*/
+static void bench_ReceiverCallback( qEvent_t e ){
+    (void)e;
+    LatencyTotal += bench_Now() - LatencyStamp;
+    LatencyPending = qFalse;
+    if( ++LatencySamples >= BENCH_LATENCY_SAMPLES ){
+        qOS_Scheduler_Release();
+    }
+}
+/*============================================================================*/
+static void bench_DeliveryLatency( size_t nTasks, benchdelivery_t mode ){
+    bench_KernelSetup();
+    LatencyMode = mode;
+    LatencySamples = 0uL;
+    LatencyTotal = 0uLL;
+    LatencyPending = qFalse;
+    if( ( qFalse == bench_AddBackgroundTasks( nTasks, bench_NullCallback ) ) ||
+        ( qFalse == qOS_Add_Task( &SenderTask, bench_SenderCallback, qLowest_Priority, qTimeImmediate, qPeriodic, qEnabled, NULL ) ) ||
+        ( qFalse == qOS_Add_EventTask( &ReceiverTask, bench_ReceiverCallback, qLowest_Priority, NULL ) ) ){
+        fprintf( stderr, "%s: unable to add %lu tasks\n", LatencyNames[ mode ], (unsigned long)nTasks );
+        return;
+    }
+    qOS_Run();
+    bench_Report( LatencyNames[ mode ], nTasks, LatencySamples, LatencyTotal );
+}
+/*============================================================================*/
+static void bench_Queue( void ){
+    #if ( Q_QUEUES == 1 )
+    qQueue_t queue;
+    int queueArea[ BENCH_QUEUE_ITEMS ];
+    int item = 0, received = 0;
+    qUINT64_t t0, sendTime = 0uLL, receiveTime = 0uLL;
+    unsigned long round;
+    size_t i;
+
+    if( qFalse == qQueue_Setup( &queue, queueArea, sizeof(int), BENCH_QUEUE_ITEMS ) ){
+        fprintf( stderr, "queue: setup failed\n" );
+        return;
+    }
+    for( round = 0uL ; round < BENCH_QUEUE_ROUNDS ; ++round ){
+        t0 = bench_Now();
+        for( i = 0u ; i < BENCH_QUEUE_ITEMS ; ++i ){
+            (void)qQueue_Send( &queue, &item, QUEUE_SEND_TO_BACK );
+        }
+        sendTime += bench_Now() - t0;
+        t0 = bench_Now();
+        for( i = 0u ; i < BENCH_QUEUE_ITEMS ; ++i ){
+            (void)qQueue_Receive( &queue, &received );
+        }
+        receiveTime += bench_Now() - t0;
+    }
+    bench_Report( "queue_send", BENCH_QUEUE_ITEMS, BENCH_QUEUE_ROUNDS*BENCH_QUEUE_ITEMS, sendTime );
+    bench_Report( "queue_receive", BENCH_QUEUE_ITEMS, BENCH_QUEUE_ROUNDS*BENCH_QUEUE_ITEMS, receiveTime );
+    #endif
+}
+/*============================================================================*/
+static qBool_t bench_ListComparator( qList_CompareHandle_t h ){
+    const benchnode_t *n1 = h->n1;
+    const benchnode_t *n2 = h->n2;
+
+    return ( n1->value > n2->value ) ? qTrue : qFalse;
+}
+/*============================================================================*/
+static qBool_t bench_SortCheck( qList_ForEachHandle_t h ){
+    benchsortcheck_t *check = h->arg;
+    const benchnode_t *xnode = h->node;
+
+    if( qList_WalkThrough == h->stage ){
+        if( NULL != check->previous ){
+            if( check->previous->value > xnode->value ){
+                check->sorted = qFalse;
+            }
+            else if( ( check->previous->value == xnode->value ) && ( check->previous->order > xnode->order ) ){
+                check->stable = qFalse;
+            }
+            else{
+                /*in order*/
+            }
+        }
+        check->previous = xnode;
+    }
+    return qFalse;
+}
+/*============================================================================*/
+static benchnode_t* bench_ListNodes( size_t n ){
+    benchnode_t *nodes;
+    unsigned long seed = 12345uL;
+    size_t i;
+
+    nodes = calloc( n, sizeof(benchnode_t) );
+    if( NULL != nodes ){
+        for( i = 0u ; i < n ; ++i ){ /*fixed pseudo-random sequence with repeated keys, same input every run*/
+            seed = ( seed*1103515245uL + 12345uL ) & 0x7FFFFFFFuL;
+            nodes[ i ].value = (int)( seed % 1000uL );
+            nodes[ i ].order = i;
+        }
+    }
+    else{
+        fprintf( stderr, "list: unable to allocate %lu nodes\n", (unsigned long)n );
+    }
+    return nodes;
+}
+/*============================================================================*/
+static void bench_List( size_t n ){
+    qList_t list;
+    benchnode_t *nodes;
+    qUINT64_t t0;
+    size_t i;
+
+    if( NULL == ( nodes = bench_ListNodes( n ) ) ){
+        return;
+    }
+    qList_Initialize( &list );
+
+    t0 = bench_Now();
+    for( i = 0u ; i < n ; ++i ){
+        (void)qList_Insert( &list, &nodes[ i ], QLIST_ATBACK );
+    }
+    bench_Report( "list_insert", n, (unsigned long)n, bench_Now() - t0 );
+
+    t0 = bench_Now();
+    for( i = 0u ; i < n ; ++i ){
+        (void)qList_Remove( &list, &nodes[ i ], QLIST_ATFRONT );
+    }
+    bench_Report( "list_remove", n, (unsigned long)n, bench_Now() - t0 );
+
+    free( nodes );
+}
+/*============================================================================*/
+static qBool_t bench_WalkSum( qList_ForEachHandle_t h ){
+    const benchnode_t *xnode = h->node;
+
+    if( qList_WalkThrough == h->stage ){
+        WalkSum += xnode->value;
+    }
+    return qFalse;
+}
+/*============================================================================*/
+static void bench_ListWalk( size_t n ){
+    qList_t list;
+    qList_Iterator_t iter;
+    benchnode_t *nodes, *inode;
+    qUINT64_t t0;
+    unsigned long round;
+    size_t i;
+
+    if( NULL == ( nodes = bench_ListNodes( n ) ) ){
+        return;
+    }
+    qList_Initialize( &list );
+    for( i = 0u ; i < n ; ++i ){
+        (void)qList_Insert( &list, &nodes[ i ], QLIST_ATBACK );
+    }
+
+    t0 = bench_Now();
+    for( round = 0uL ; round < BENCH_WALK_ROUNDS ; ++round ){
+        (void)qList_ForEach( &list, bench_WalkSum, NULL, QLIST_FORWARD, NULL );
+    }
+    bench_Report( "list_walk_foreach", n, BENCH_WALK_ROUNDS*n, bench_Now() - t0 );
+
+    t0 = bench_Now();
+    for( round = 0uL ; round < BENCH_WALK_ROUNDS ; ++round ){
+        (void)qList_IteratorSet( &iter, &list, &nodes[ 0 ], QLIST_FORWARD );
+        while( NULL != ( inode = (benchnode_t*)qList_IteratorGetNext( &iter ) ) ){
+            WalkSum += inode->value;
+        }
+    }
+    bench_Report( "list_walk_iterator", n, BENCH_WALK_ROUNDS*n, bench_Now() - t0 );
+
+    t0 = bench_Now();
+    for( round = 0uL ; round < BENCH_WALK_ROUNDS ; ++round ){ /*lower bound: plain pointer chase from the head node*/
+        for( inode = &nodes[ 0 ] ; NULL != inode ; inode = (benchnode_t*)inode->next ){
+            WalkSum += inode->value;
+        }
+    }
+    bench_Report( "list_walk_pointer", n, BENCH_WALK_ROUNDS*n, bench_Now() - t0 );
+
+    free( nodes );
+}
+/*============================================================================*/
+static void bench_ListSort( size_t n ){
+    qList_t list;
+    benchnode_t *nodes;
+    benchsortcheck_t check = { NULL, qTrue, qTrue };
+    qUINT64_t t0;
+    size_t i;
+
+    if( NULL == ( nodes = bench_ListNodes( n ) ) ){
+        return;
+    }
+    qList_Initialize( &list );
+    for( i = 0u ; i < n ; ++i ){
+        (void)qList_Insert( &list, &nodes[ i ], QLIST_ATBACK );
+    }
+    t0 = bench_Now();
+    (void)qList_Sort( &list, bench_ListComparator );
+    bench_Report( "list_sort", n, 1uL, bench_Now() - t0 );
+
+    (void)qList_ForEach( &list, bench_SortCheck, &check, QLIST_FORWARD, NULL );
+    printf( "{\"bench\":\"list_sort_check\",\"priority_levels\":%d,\"n\":%lu,\"sorted\":%s,\"stable\":%s}\n",
+            Q_PRIORITY_LEVELS, (unsigned long)n, ( qTrue == check.sorted ) ? "true" : "false", ( qTrue == check.stable ) ? "true" : "false" );
+    free( nodes );
+}
+/*============================================================================*/
+static void bench_MemoryManagement( void ){
+    #if ( Q_MEMORY_MANAGER == 1 )
+    qMemMang_Pool_t pool;
+    void *block;
+    qUINT64_t t0;
+    unsigned long round;
+    size_t i;
+
+    if( qFalse == qMemMang_Pool_Setup( &pool, MemPoolArea, sizeof(MemPoolArea) ) ){
+        fprintf( stderr, "memory: pool setup failed\n" );
+        return;
+    }
+    qMemMang_Pool_Select( &pool );
+    for( i = 0u ; i < qFLM_ArraySize( MemSizeSweep ) ; ++i ){
+        t0 = bench_Now();
+        for( round = 0uL ; round < BENCH_MEM_ROUNDS ; ++round ){
+            block = qMalloc( MemSizeSweep[ i ] );
+            qFree( block );
+        }
+        bench_Report( "malloc_free", MemSizeSweep[ i ], BENCH_MEM_ROUNDS, bench_Now() - t0 );
+    }
+    qMemMang_Pool_Select( NULL );
+    #endif
+}
+/*============================================================================*/
+int main(int argc, char** argv) {
+    size_t i;
+    (void)argc;
+    (void)argv;
+
+    for( i = 0u ; i < qFLM_ArraySize( TaskCountSweep ) ; ++i ){
+        bench_Dispatch( TaskCountSweep[ i ] );
+        bench_DeliveryLatency( TaskCountSweep[ i ], BENCH_BY_SIMPLE_NOTIFICATION );
+        #if ( Q_PRIO_QUEUE_SIZE > 0 )
+            bench_DeliveryLatency( TaskCountSweep[ i ], BENCH_BY_QUEUED_NOTIFICATION );
+        #endif
+        #if ( Q_ALLOW_YIELD_TO_TASK == 1 )
+            bench_DeliveryLatency( TaskCountSweep[ i ], BENCH_BY_YIELD_TO_TASK );
+        #endif
+    }
+    bench_Queue();
+    for( i = 0u ; i < qFLM_ArraySize( ListSizeSweep ) ; ++i ){
+        bench_List( ListSizeSweep[ i ] );
+        bench_ListWalk( ListSizeSweep[ i ] );
+    }
+    for( i = 0u ; i < qFLM_ArraySize( SortSizeSweep ) ; ++i ){
+        bench_ListSort( SortSizeSweep[ i ] );
+    }
+    bench_MemoryManagement();
+    if( 0L == WalkSum ){ /*keep the walks observable*/
+        fprintf( stderr, "list walks visited no nodes\n" );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -43,6 +43,10 @@ embedded C compilers in real hardware( these are not included in this repository
         #define T30SEC          30000
     #endif
 
+    #ifndef X86_TEST_VIRTUAL_CLOCK
+        #define X86_TEST_VIRTUAL_CLOCK  ( 1 )   /*use the simulated tick instead of the wall-clock*/
+    #endif
+
 
 /*===========================Reference clock for the kernel===================*/
 qClock_t GetTickCountMs(void){ /*get system background timer (1mS tick)*/
@@ -51,6 +55,19 @@ qClock_t GetTickCountMs(void){ /*get system background timer (1mS tick)*/
     return (qClock_t)(ts.tv_nsec / (qClock_t)1000000uL) + ((qClock_t)ts.tv_sec * (qClock_t)1000uL);
 }
 /*============================================================================*/
+#if ( X86_TEST_VIRTUAL_CLOCK == 1 )
+/*Simulated 1mS tick. Time only advances from the idle task, that is, when
+no task is ready, so the scheduling scenario runs as fast as the host allows
+and every run observes the same sequence of ticks*/
+static qClock_t VirtualTick = 0uL;
+qClock_t GetTickVirtual(void){
+    return VirtualTick;
+}
+    #define TEST_TICK_FCN   GetTickVirtual
+#else
+    #define TEST_TICK_FCN   GetTickCountMs
+#endif
+/*============================================================================*/
 /*For unity --------------------------------------------------------------------------*/
 void setUp (void) {} /* Is run before every test, put unit init calls here. */
 void tearDown (void) {} /* Is run after every test, put unit clean-up calls here. */
@@ -160,6 +177,11 @@ void test_qList_API(void){
     TEST_ASSERT_EQUAL_UINT8( qFalse, qList_ForEach( &mylist, mylist_visualizer, NULL, QLIST_FORWARD, NULL ) );
     TEST_ASSERT_EQUAL_UINT8( qFalse, qList_ForEach( &otherlist, mylist_visualizer, NULL, QLIST_FORWARD, NULL ) );
     TEST_ASSERT_EQUAL_UINT8( qFalse, qList_ForEach( &mylist, mylist_binremove, &mylist, QLIST_FORWARD, NULL ) );
+    TEST_ASSERT_EQUAL_UINT8( qFalse, qList_IsMember(&mylist, &n1) ); /*odd nodes now belong to otherlist*/
+    TEST_ASSERT_EQUAL_UINT8( qTrue, qList_IsMember(&otherlist, &n1) );
+    TEST_ASSERT_EQUAL_UINT8( qTrue, qList_IsMember(&mylist, &n2) );
+    TEST_ASSERT_EQUAL_UINT8( qFalse, qList_IsMember(&otherlist, &n2) );
+    TEST_ASSERT_EQUAL_UINT8( qFalse, qList_Insert( &otherlist, &n3, QLIST_ATFRONT ) ); /*node n3 its already a member*/
     TEST_ASSERT_EQUAL_UINT8( qFalse, qList_ForEach( &mylist, mylist_visualizer, NULL, QLIST_FORWARD, NULL ) );
     TEST_ASSERT_EQUAL_UINT8( qFalse, qList_ForEach( &otherlist, mylist_visualizer, NULL, QLIST_FORWARD, NULL ) );
     TEST_ASSERT_EQUAL_UINT8( qFalse, qList_ForEach( &otherlist, mylist_visualizer, NULL, QLIST_BACKWARD, NULL ) );
@@ -373,6 +395,9 @@ void IdleTaskCallback(qEvent_t e){
 
     static qSTimer_t EndSchedulingTimeout = QSTIMER_INITIALIZER;
 
+    #if ( X86_TEST_VIRTUAL_CLOCK == 1 )
+        ++VirtualTick;
+    #endif
     TEST_ASSERT_EQUAL_UINT8( qTrue, qEdgeCheck_Update(&INPUTS) );
 
     if(e->FirstCall){
@@ -554,9 +579,9 @@ void test_OS_API( void ){
     #endif
     TEST_MESSAGE( "OS scheduling..." ); 
     #if  (Q_SETUP_TIME_CANONICAL != 1)
-        qOS_Setup(GetTickCountMs, 0.001f, IdleTaskCallback ); /*  IdleTaskCallback  */ 
+        qOS_Setup(TEST_TICK_FCN, 0.001f, IdleTaskCallback ); /*  IdleTaskCallback  */ 
     #else
-        qOS_Setup(GetTickCountMs, IdleTaskCallback ); /*  IdleTaskCallback  */
+        qOS_Setup(TEST_TICK_FCN, IdleTaskCallback ); /*  IdleTaskCallback  */
     #endif
     #if (Q_ALLOW_SCHEDULER_RELEASE == 1)
         qOS_Set_SchedulerReleaseCallback( scheduler_Release );